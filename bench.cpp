@@ -0,0 +1,88 @@
+#include <iostream>
+#include <algorithm>  //std::sort, std::unique
+#include <chrono>
+#include <random>
+#include <string>
+#include <thread>
+
+#include "set.hpp"
+
+/*
+ * Benchmark of the parallel constructor Set(Set::parallel_policy, const std::vector<int>&)
+ * Usage: bench [number of elements]  (default 100 000 000)
+ * The Set is built with 1, 2, 4, ... threads, and with the number of hardware threads
+ * Baselines: sorting and removing repeated values of a copy of the vector with std::sort and std::unique,
+ * without and with creating the Set from the result with Set::Builder
+ * (the sequential constructor Set(const std::vector<int>&) is too slow for large vectors)
+ */
+
+int main(int argc, char* argv[]) {
+    const std::size_t n = (argc > 1) ? std::stoul(argv[1]) : 100'000'000;
+
+    std::mt19937 gen{2024};
+    std::uniform_int_distribution<int> dist{};
+
+    std::vector<int> elements(n);
+    for (int& x : elements) {
+        x = dist(gen);
+    }
+
+    const unsigned max_threads = std::max(1u, std::thread::hardware_concurrency());
+
+    std::cout << "elements: " << n << "  hardware threads: " << max_threads << "\n";
+
+    double base_time = 0.0;
+    {
+        auto start = std::chrono::steady_clock::now();
+        std::vector<int> sorted{elements};
+        std::sort(sorted.begin(), sorted.end());
+        sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+        auto stop = std::chrono::steady_clock::now();
+
+        double time = std::chrono::duration<double>(stop - start).count();
+        std::cout << "baseline (std::sort + std::unique, no Set)  time: " << time << " s"
+                  << "  (unique values " << sorted.size() << ")\n";
+    }
+    {
+        auto start = std::chrono::steady_clock::now();
+        std::vector<int> sorted{elements};
+        std::sort(sorted.begin(), sorted.end());
+        sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+
+        Set::Builder B{};
+        for (int x : sorted) {
+            B.add(x);
+        }
+        Set S = B.finish();
+        auto stop = std::chrono::steady_clock::now();
+
+        base_time = std::chrono::duration<double>(stop - start).count();
+        std::cout << "baseline (std::sort + std::unique + Set::Builder)  time: " << base_time << " s"
+                  << "  (cardinality " << S.cardinality() << ")\n";
+    }
+
+    // 1, 2, 4, ... threads, always ending with max_threads
+    std::vector<unsigned> thread_counts;
+    for (unsigned threads = 1; threads < max_threads; threads *= 2) {
+        thread_counts.push_back(threads);
+    }
+    thread_counts.push_back(max_threads);
+
+    double one_thread_time = 0.0;
+
+    for (unsigned threads : thread_counts) {
+        auto start = std::chrono::steady_clock::now();
+        Set S{Set::parallel_policy{threads}, elements};
+        auto stop = std::chrono::steady_clock::now();
+
+        double time = std::chrono::duration<double>(stop - start).count();
+        if (threads == 1) {
+            one_thread_time = time;
+        }
+
+        std::cout << "threads: " << threads << "  time: " << time << " s"
+                  << "  speedup vs 1 thread: " << one_thread_time / time
+                  << "  vs baseline: " << base_time / time << "  (cardinality " << S.cardinality()
+                  << ")\n";
+    }
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <exception>  //std::exception_ptr
+#include <vector>
+#include <thread>
+
+// Internal helper of set.cpp and sharded_set.cpp, not part of the interface of the library
+
+namespace detail {
+
+// Call f(i) for i = 0, 1, ..., n-1, each call in its own thread
+// f(0) runs in the calling thread
+// All threads are joined before returning, also when an exception is thrown
+// The exception of the call with the smallest i is rethrown to the caller
+template <typename Function>
+void parallel_for(std::size_t n, Function f) {
+    if (n == 0) {
+        return;
+    }
+
+    std::vector<std::exception_ptr> errors(n);
+
+    auto run = [&f, &errors](std::size_t i) {
+        try {
+            f(i);
+        } catch (...) {
+            errors[i] = std::current_exception();
+        }
+    };
+
+    // Joins the started threads when leaving the scope, e.g. if creating a thread throws
+    struct Joiner {
+        std::vector<std::thread> threads;
+
+        ~Joiner() {
+            for (std::thread& t : threads) {
+                t.join();
+            }
+        }
+    };
+
+    {
+        Joiner joiner{};
+        joiner.threads.reserve(n);
+
+        for (std::size_t i = 1; i < n; ++i) {
+            joiner.threads.emplace_back(run, i);
+        }
+        run(0);
+    }
+
+    for (std::exception_ptr& e : errors) {
+        if (e) {
+            std::rethrow_exception(e);
+        }
+    }
+}
+
+}  // namespace detail
@@ -1,5 +1,13 @@
 #include "set.hpp"
 
+#include <algorithm>  //std::sort, std::unique, std::upper_bound
+#include <stdexcept>  //std::invalid_argument
+#include <atomic>
+#include <cstdint>  //std::uint16_t
+#include <thread>
+
+#include "parallel_for.hpp"
+
 /*
  * std::size_t is defined in the C++ standard library
  * std::size_t is an unsigned integer type that can store the maximum size of any possible object
@@ -17,6 +25,14 @@ public:
         ++count_nodes;
     }
 
+    // Constructor: create a node without counting it in count_nodes
+    // The caller must add the number of such nodes to count_nodes itself
+    // Used by threads creating many nodes, to keep the shared counter out of the loop
+    struct uncounted_t {};
+    Node(uncounted_t, int nodeVal) : value{nodeVal}, next{nullptr} {
+        //
+    }
+
     // Destructor
     ~Node() {
         --count_nodes;
@@ -27,7 +43,8 @@ public:
 
     // Total number of existing nodes -- used only to help to detect bugs in the code
     // Cannot be used in the implementation of any member functions
-    static std::size_t count_nodes;
+    // Atomic, since nodes may be created by several threads (see the parallel constructor)
+    static std::atomic<std::size_t> count_nodes;
 
     friend std::ostream& operator<<(std::ostream& os, const Set& rhs);
 };
@@ -35,7 +52,7 @@ public:
 /* ************************************ */
 
 // Initialize the counter of the total number of existing nodes
-std::size_t Set::Node::count_nodes = 0;
+std::atomic<std::size_t> Set::Node::count_nodes{0};
 
 // Used only for debug purposes
 // Return number of existing nodes
@@ -91,6 +108,148 @@ Set::Set(const std::vector<int>& elements) : Set() {
 
 }
 
+// Constructor: create a set with elements, using several threads
+// elements is not sorted and values in it may not be unique
+// Algorithm (sample sort):
+// 1. pick splitters from a sample of elements, dividing the values into one bucket per thread
+// 2. each thread moves its part of elements to the buckets
+// 3. each thread sorts one bucket, removes repeated values, and creates the nodes for it
+// 4. the bucket lists are linked together, in increasing order of the buckets
+// With one thread, steps 1 and 2 are skipped
+Set::Set(parallel_policy policy, const std::vector<int>& elements) : Set() {
+    const std::size_t min_per_thread = 1 << 16;  // smaller inputs do not pay off the threads
+    const std::size_t max_buckets = 1 << 16;     // bucket numbers are stored in 16 bits
+    const std::size_t oversampling = 32;
+    const std::size_t n = elements.size();
+
+    std::size_t T = (policy.threads > 0) ? policy.threads : std::thread::hardware_concurrency();
+    T = std::max<std::size_t>(1, std::min({T, n / min_per_thread, max_buckets}));
+
+    // bucket b is stored in buffer[start[b], start[b + 1])
+    std::vector<int> buffer;
+    std::vector<std::size_t> start;
+
+    if (T == 1) {
+        // one bucket: no splitters and no scatter pass needed
+        buffer = elements;
+        start = {0, n};
+    }
+    else {
+        // 1. splitters: value x belongs to bucket upper_bound(splitters, x)
+        std::vector<int> sample;
+        for (std::size_t i = 0; i < T * oversampling; ++i) {
+            sample.push_back(elements[i * n / (T * oversampling)]);
+        }
+        std::sort(sample.begin(), sample.end());
+
+        std::vector<int> splitters;
+        for (std::size_t b = 1; b < T; ++b) {
+            splitters.push_back(sample[b * oversampling]);
+        }
+
+        auto bucket_of = [&splitters](int x) -> std::size_t {
+            return std::upper_bound(splitters.begin(), splitters.end(), x) - splitters.begin();
+        };
+
+        // 2. bucket[i] is the bucket of elements[i]
+        // count[t * T + b] is the number of values in part t of elements that belong to bucket b
+        // Each thread counts in its own local array and writes its row of count once,
+        // so that threads do not write to the same cache lines in the loop
+        std::vector<std::uint16_t> bucket(n);
+        std::vector<std::size_t> count(T * T, 0);
+
+        detail::parallel_for(T, [&](std::size_t t) {
+            std::vector<std::size_t> local_count(T, 0);
+
+            for (std::size_t i = t * n / T; i < (t + 1) * n / T; ++i) {
+                const std::size_t b = bucket_of(elements[i]);
+                bucket[i] = static_cast<std::uint16_t>(b);
+                ++local_count[b];
+            }
+
+            std::copy(local_count.begin(), local_count.end(), count.begin() + t * T);
+        });
+
+        // part t writes its values of bucket b from position offset[t * T + b]
+        start.assign(T + 1, 0);
+        std::vector<std::size_t> offset(T * T, 0);
+
+        for (std::size_t b = 0; b < T; ++b) {
+            std::size_t pos = start[b];
+            for (std::size_t t = 0; t < T; ++t) {
+                offset[t * T + b] = pos;
+                pos += count[t * T + b];
+            }
+            start[b + 1] = pos;
+        }
+
+        buffer.resize(n);
+
+        detail::parallel_for(T, [&](std::size_t t) {
+            std::vector<std::size_t> local_offset(offset.begin() + t * T, offset.begin() + (t + 1) * T);
+
+            for (std::size_t i = t * n / T; i < (t + 1) * n / T; ++i) {
+                buffer[local_offset[bucket[i]]++] = elements[i];
+            }
+        });
+    }
+
+    // 3. the list of bucket b goes from first[b] to last[b], with size[b] nodes
+    std::vector<Node*> first(T, nullptr);
+    std::vector<Node*> last(T, nullptr);
+    std::vector<std::size_t> size(T, 0);
+
+    try {
+        detail::parallel_for(T, [&](std::size_t b) {
+            auto begin = buffer.begin() + start[b];
+            auto end = buffer.begin() + start[b + 1];
+
+            std::sort(begin, end);
+            end = std::unique(begin, end);
+
+            // first[b] always points to the nodes created so far, so they can be deleted on failure
+            Node** link = &first[b];
+            std::size_t k = 0;
+
+            try {
+                for (auto it = begin; it != end; ++it) {
+                    *link = new Node(Node::uncounted_t{}, *it);
+                    last[b] = *link;
+                    link = &last[b]->next;
+                    ++k;
+                }
+            } catch (...) {
+                Node::count_nodes += k;
+                throw;
+            }
+
+            Node::count_nodes += k;  // one update of the shared counter per bucket
+            size[b] = k;
+        });
+    } catch (...) {
+        // delete the nodes of all buckets, the Set itself is deleted by the destructor
+        for (Node* ptr : first) {
+            while (ptr != nullptr) {
+                Node* temp = ptr->next;
+                delete ptr;
+                ptr = temp;
+            }
+        }
+        throw;
+    }
+
+    // 4. link the bucket lists
+    Node* ptr = head;
+
+    for (std::size_t b = 0; b < T; ++b) {
+        if (first[b] != nullptr) {
+            ptr->next = first[b];
+            ptr = last[b];
+            counter += size[b];
+        }
+    }
+}
+
 // copy constructor
 Set::Set(const Set& rhs) : Set() {
     Node* rhsptr = rhs.head->next;
@@ -124,6 +283,25 @@ Set::~Set() {
     }
 }
 
+// Insert x in the set
+// Return true, if x was inserted
+// Otherwise, x was already an element and false is returned
+bool Set::insert(int x) {
+    Node* ptr = head;
+
+    while (ptr->next != nullptr && ptr->next->value < x) {
+        ptr = ptr->next;
+    }
+
+    if (ptr->next != nullptr && ptr->next->value == x) {
+        return false;
+    }
+
+    ptr->next = new Node(x, ptr->next);
+    counter++;
+    return true;
+}
+
 // Return number of elements in the set
 std::size_t Set::cardinality() const {
     return counter;  // delete, if needed
@@ -283,4 +461,40 @@ std::ostream& operator<<(std::ostream& os, const Set& rhs) {
     return os;
 }
 
+/* *********** class Set::Builder member functions ************ */
+
+// Constructor: start with an empty Set
+Set::Builder::Builder() : S{}, tail{S.head} {
+    //
+}
+
+// Append x to the end of the Set
+// x must be larger than all values appended before, otherwise std::invalid_argument is thrown
+void Set::Builder::add(int x) {
+    if (tail != S.head && x <= tail->value) {
+        throw std::invalid_argument{"Set::Builder::add: values must be increasingly sorted"};
+    }
+
+    tail->next = new Node(x);
+    tail = tail->next;
+    S.counter++;
+}
+
+// Append all elements of A to the end of the Set
+// The elements of A must be larger than all values appended before
+void Set::Builder::add(const Set& A) {
+    for (Node* ptr = A.head->next; ptr != nullptr; ptr = ptr->next) {
+        add(ptr->value);
+    }
+}
+
+// Return the Set built so far and start over with an empty Set
+Set Set::Builder::finish() {
+    Set result{};
+    std::swap(result.head, S.head);
+    std::swap(result.counter, S.counter);
+    tail = S.head;
+    return result;
+}
+
 /********** Private member functions ************/
@@ -7,6 +7,13 @@
 // Class Set represents a set of integers using an increasingly sorted singly-linked list
 class Set {
 public:
+    // Execution policy selecting the parallel version of a constructor
+    // Usage: Set S{Set::par, elements}; or Set S{Set::parallel_policy{4}, elements};
+    struct parallel_policy {
+        unsigned threads;  // maximum number of threads, 0 means all hardware threads
+    };
+    static constexpr parallel_policy par{0};
+
     // Default constructor
     Set();
 
@@ -17,6 +24,10 @@ public:
     // elements is not sorted and values in it may not be unique
     explicit Set(const std::vector<int>& elements);
 
+    // Constructor: create a set with elements, using several threads
+    // elements is not sorted and values in it may not be unique
+    explicit Set(parallel_policy policy, const std::vector<int>& elements);
+
     // Copy constructor
     Set(const Set& rhs);
 
@@ -26,6 +37,7 @@ public:
     // Destructor
     ~Set();
 
+    bool insert(int x);               // Insert x, return false if x was already an element
     bool member(int x) const;         // Test if x is an element of the set
     bool empty() const;               // Test if set is empty
     std::size_t cardinality() const;  // Return number of elements in the set
@@ -47,6 +59,8 @@ public:
     // Used only for debug purposes
     static std::size_t get_count_nodes();
 
+    class Builder;  // builds a Set from increasingly sorted values, one at a time
+
 private:
     class Node;  // class Node definition is in set.cpp
 
@@ -59,3 +73,30 @@ private:
 
     /* Add Auxiliarly functions, if needed */
 };
+
+// Class Set::Builder appends values to the end of a Set under construction
+// Values must be given in increasing order, e.g. as produced by a sorted stream
+// Each value is added in constant time, without rescanning the list
+class Set::Builder {
+public:
+    // Constructor: start with an empty Set
+    Builder();
+
+    Builder(const Builder&) = delete;
+    Builder& operator=(const Builder&) = delete;
+
+    // Append x to the end of the Set
+    // x must be larger than all values appended before, otherwise std::invalid_argument is thrown
+    void add(int x);
+
+    // Append all elements of A to the end of the Set
+    // The elements of A must be larger than all values appended before
+    void add(const Set& A);
+
+    // Return the Set built so far and start over with an empty Set
+    Set finish();
+
+private:
+    Set S;
+    Node* tail;  // points to the last node of S
+};
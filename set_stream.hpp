@@ -0,0 +1,144 @@
+#pragma once
+
+#include <stdexcept>    //std::invalid_argument
+#include <type_traits>  //std::is_same
+
+#include "set.hpp"
+
+/*
+ * Streaming versions of Set::set_union, Set::set_intersection, and Set::set_difference
+ *
+ * The inputs are two increasingly sorted sequences given by input iterators,
+ * e.g. std::istream_iterator<int> reading from a file or a socket, or the iterators of a generator
+ * Values in an input may be repeated, repeated values are skipped
+ * An input that is not sorted makes the functions throw std::invalid_argument
+ *
+ * Each result value is handed to emit (any callable taking an int) as soon as it is known,
+ * so only the current value of each input is kept in memory
+ * The overloads without emit collect the result in a Set, using Set::Builder
+ */
+
+namespace set_stream {
+
+// Move it past all values equal to *it
+// Throw std::invalid_argument, if the next value is smaller than *it
+template <typename InIt, typename End>
+void next_unique(InIt& it, const End& last) {
+    static_assert(std::is_same<std::decay_t<decltype(*it)>, int>::value,
+                  "set_stream: the inputs must be sequences of int");
+
+    const int value = *it;
+    do {
+        ++it;
+    } while (it != last && *it == value);
+
+    if (it != last && *it < value) {
+        throw std::invalid_argument{"set_stream: input is not sorted"};
+    }
+}
+
+// Emit the union of the sorted inputs [first1, last1) and [first2, last2)
+template <typename InIt1, typename End1, typename InIt2, typename End2, typename Emit>
+void set_union(InIt1 first1, End1 last1, InIt2 first2, End2 last2, Emit emit) {
+    while (first1 != last1 && first2 != last2) {
+        const int x1 = *first1;
+        const int x2 = *first2;
+
+        if (x1 < x2) {
+            emit(x1);
+            next_unique(first1, last1);
+        }
+        else if (x2 < x1) {
+            emit(x2);
+            next_unique(first2, last2);
+        }
+        else {
+            emit(x1);
+            next_unique(first1, last1);
+            next_unique(first2, last2);
+        }
+    }
+
+    while (first1 != last1) {
+        emit(*first1);
+        next_unique(first1, last1);
+    }
+
+    while (first2 != last2) {
+        emit(*first2);
+        next_unique(first2, last2);
+    }
+}
+
+// Emit the intersection of the sorted inputs [first1, last1) and [first2, last2)
+template <typename InIt1, typename End1, typename InIt2, typename End2, typename Emit>
+void set_intersection(InIt1 first1, End1 last1, InIt2 first2, End2 last2, Emit emit) {
+    while (first1 != last1 && first2 != last2) {
+        const int x1 = *first1;
+        const int x2 = *first2;
+
+        if (x1 < x2) {
+            next_unique(first1, last1);
+        }
+        else if (x2 < x1) {
+            next_unique(first2, last2);
+        }
+        else {
+            emit(x1);
+            next_unique(first1, last1);
+            next_unique(first2, last2);
+        }
+    }
+}
+
+// Emit the difference between the sorted inputs [first1, last1) and [first2, last2)
+template <typename InIt1, typename End1, typename InIt2, typename End2, typename Emit>
+void set_difference(InIt1 first1, End1 last1, InIt2 first2, End2 last2, Emit emit) {
+    while (first1 != last1 && first2 != last2) {
+        const int x1 = *first1;
+        const int x2 = *first2;
+
+        if (x1 < x2) {
+            emit(x1);
+            next_unique(first1, last1);
+        }
+        else if (x2 < x1) {
+            next_unique(first2, last2);
+        }
+        else {
+            next_unique(first1, last1);
+            next_unique(first2, last2);
+        }
+    }
+
+    while (first1 != last1) {
+        emit(*first1);
+        next_unique(first1, last1);
+    }
+}
+
+// Return a new Set representing the union of the sorted inputs
+template <typename InIt1, typename End1, typename InIt2, typename End2>
+Set set_union(InIt1 first1, End1 last1, InIt2 first2, End2 last2) {
+    Set::Builder B{};
+    set_stream::set_union(first1, last1, first2, last2, [&B](int x) { B.add(x); });
+    return B.finish();
+}
+
+// Return a new Set representing the intersection of the sorted inputs
+template <typename InIt1, typename End1, typename InIt2, typename End2>
+Set set_intersection(InIt1 first1, End1 last1, InIt2 first2, End2 last2) {
+    Set::Builder B{};
+    set_stream::set_intersection(first1, last1, first2, last2, [&B](int x) { B.add(x); });
+    return B.finish();
+}
+
+// Return a new Set representing the difference between the sorted inputs
+template <typename InIt1, typename End1, typename InIt2, typename End2>
+Set set_difference(InIt1 first1, End1 last1, InIt2 first2, End2 last2) {
+    Set::Builder B{};
+    set_stream::set_difference(first1, last1, first2, last2, [&B](int x) { B.add(x); });
+    return B.finish();
+}
+
+}  // namespace set_stream
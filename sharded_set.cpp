@@ -0,0 +1,178 @@
+#include "sharded_set.hpp"
+
+#include <mutex>      //std::unique_lock, std::lock
+#include <stdexcept>  //std::invalid_argument, std::logic_error
+
+#include "parallel_for.hpp"
+
+/* *********** class ShardedSet member functions ************ */
+
+// Constructor: create an empty set with the given number of shards
+// partitioning the range of values [min_value, max_value]
+// Throw std::invalid_argument, if there are no shards or the range is empty
+ShardedSet::ShardedSet(std::size_t n, int min_value, int max_value)
+    : shards{}, min_key{key_of(min_value)}, width{0} {
+    if (n == 0 || min_value > max_value) {
+        throw std::invalid_argument{"ShardedSet: needs at least one shard and min_value <= max_value"};
+    }
+
+    const std::uint64_t range = std::uint64_t{key_of(max_value)} - min_key + 1;
+    width = (range + n - 1) / n;  // round up, so that n shards cover the range
+
+    for (std::size_t i = 0; i < n; ++i) {
+        shards.push_back(std::make_unique<Shard>());
+    }
+}
+
+// Insert x in the set
+// Return true, if x was inserted
+// Otherwise, x was already an element and false is returned
+// Throw std::logic_error, if *this was moved from
+bool ShardedSet::insert(int x) {
+    if (shards.empty()) {
+        throw std::logic_error{"ShardedSet: insert into a moved-from ShardedSet"};
+    }
+
+    Shard& shard = *shards[shard_of(x)];
+    std::unique_lock<std::shared_mutex> lock{shard.mutex};
+
+    return shard.S.insert(x);
+}
+
+// Test if x is an element of the set
+bool ShardedSet::member(int x) const {
+    if (shards.empty()) {  // moved-from
+        return false;
+    }
+
+    const Shard& shard = *shards[shard_of(x)];
+    std::shared_lock<std::shared_mutex> lock{shard.mutex};
+
+    return shard.S.member(x);
+}
+
+// Test if set is empty
+bool ShardedSet::empty() const {
+    return cardinality() == 0;
+}
+
+// Return number of elements in the set
+std::size_t ShardedSet::cardinality() const {
+    auto locks = lock_all();
+    std::size_t n = 0;
+
+    for (const auto& shard : shards) {
+        n += shard->S.cardinality();
+    }
+    return n;
+}
+
+// Return a Set with all elements, as they were at one moment
+// The shards are locked together, so no element can be inserted while copying
+Set ShardedSet::to_set() const {
+    auto locks = lock_all();
+    Set::Builder B{};
+
+    for (const auto& shard : shards) {
+        B.add(shard->S);  // shards are in increasing order of values
+    }
+    return B.finish();
+}
+
+// Return number of shards
+std::size_t ShardedSet::shard_count() const {
+    return shards.size();
+}
+
+// Return a new ShardedSet representing the union of *this and b
+ShardedSet ShardedSet::set_union(const ShardedSet& b) const {
+    return combine(b, [](const Set& A, const Set& B) { return A.set_union(B); });
+}
+
+// Return a new ShardedSet representing the intersection of *this and b
+ShardedSet ShardedSet::set_intersection(const ShardedSet& b) const {
+    return combine(b, [](const Set& A, const Set& B) { return A.set_intersection(B); });
+}
+
+// Return a new ShardedSet representing the difference between *this and b
+ShardedSet ShardedSet::set_difference(const ShardedSet& b) const {
+    return combine(b, [](const Set& A, const Set& B) { return A.set_difference(B); });
+}
+
+/********** Private member functions ************/
+
+// Constructor: create an empty set with the same shards as b
+ShardedSet::ShardedSet(same_shards_as_t, const ShardedSet& b)
+    : shards{}, min_key{b.min_key}, width{b.width} {
+    for (std::size_t i = 0; i < b.shards.size(); ++i) {
+        shards.push_back(std::make_unique<Shard>());
+    }
+}
+
+// Return x as an unsigned key, such that x < y if and only if key_of(x) < key_of(y)
+std::uint32_t ShardedSet::key_of(int x) {
+    return static_cast<std::uint32_t>(x) ^ 0x80000000u;  // flip the sign bit
+}
+
+// Return the index of the shard for value x
+// There must be at least one shard
+std::size_t ShardedSet::shard_of(int x) const {
+    assert(!shards.empty());
+
+    const std::uint32_t key = key_of(x);
+
+    if (key < min_key) {
+        return 0;
+    }
+
+    const std::uint64_t i = (key - min_key) / width;
+    return (i < shards.size()) ? i : shards.size() - 1;
+}
+
+// Return true, if *this and b partition the values in the same way
+bool ShardedSet::same_shards(const ShardedSet& b) const {
+    return shards.size() == b.shards.size() && min_key == b.min_key && width == b.width;
+}
+
+// Lock all shards for reading, in increasing order of the shards
+// Writers lock only one shard at a time, so this cannot deadlock
+std::vector<std::shared_lock<std::shared_mutex>> ShardedSet::lock_all() const {
+    std::vector<std::shared_lock<std::shared_mutex>> locks;
+    locks.reserve(shards.size());
+
+    for (const auto& shard : shards) {
+        locks.emplace_back(shard->mutex);
+    }
+    return locks;
+}
+
+// Return a new ShardedSet whose shard i is op(shards[i]->S, b.shards[i]->S)
+// Shard i of *this and b are locked while shard i of the result is computed
+template <typename Operation>
+ShardedSet ShardedSet::combine(const ShardedSet& b, Operation op) const {
+    if (!same_shards(b)) {
+        throw std::invalid_argument{"ShardedSet: set operations require the same shards"};
+    }
+
+    ShardedSet result{same_shards_as_t{}, *this};
+
+    detail::parallel_for(shards.size(), [&](std::size_t i) {
+        const Shard& lhs = *shards[i];
+        const Shard& rhs = *b.shards[i];
+
+        std::shared_lock<std::shared_mutex> lock_lhs{lhs.mutex, std::defer_lock};
+        std::shared_lock<std::shared_mutex> lock_rhs{rhs.mutex, std::defer_lock};
+
+        // std::lock avoids a deadlock with a concurrent b.op(*this)
+        // a.set_union(a) must not lock the same shard twice
+        if (&lhs != &rhs) {
+            std::lock(lock_lhs, lock_rhs);
+        } else {
+            lock_lhs.lock();
+        }
+
+        result.shards[i]->S = op(lhs.S, rhs.S);
+    });
+
+    return result;
+}
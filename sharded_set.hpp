@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstdint>  //std::uint32_t, std::uint64_t
+#include <memory>
+#include <shared_mutex>
+#include <vector>
+
+#include "set.hpp"
+
+// Class ShardedSet represents a set of integers that can be used by several threads at the same time
+// The range of values is partitioned into shards of (almost) equal size,
+// each shard stores its values in a Set guarded by its own lock
+// Values smaller (larger) than the range go to the first (last) shard
+//
+// Threads only run in parallel when they use different shards, so the range should be the range
+// of the values actually inserted: e.g. with the range [INT_MIN, INT_MAX] and 32 shards,
+// all values in [0, 2^27) go to the same shard
+// insert and member scan the Set of one shard, i.e. their cost (and the time the shard is locked)
+// grows with the number of elements in the shard
+class ShardedSet {
+public:
+    // Constructor: create an empty set with the given number of shards
+    // partitioning the range of values [min_value, max_value]
+    // Throw std::invalid_argument, if shards == 0 or min_value > max_value
+    ShardedSet(std::size_t shards, int min_value, int max_value);
+
+    // A ShardedSet can be moved, but not copied -- use to_set() to get a copy
+    // A moved-from ShardedSet has no shards: it is empty, member returns false,
+    // and insert throws std::logic_error
+    ShardedSet(ShardedSet&&) = default;
+    ShardedSet& operator=(ShardedSet&&) = default;
+
+    // Member functions insert, member, empty, cardinality, and to_set
+    // can be called by several threads at the same time
+
+    bool insert(int x);               // Insert x, return false if x was already an element
+    bool member(int x) const;         // Test if x is an element of the set
+    bool empty() const;               // Test if set is empty
+    std::size_t cardinality() const;  // Return number of elements in the set
+
+    // Return a Set with all elements, as they were at one moment
+    Set to_set() const;
+
+    std::size_t shard_count() const;  // Return number of shards
+
+    // Set operations -- *this and b must have the same shards, otherwise std::invalid_argument is thrown
+    // Each shard is computed by its own thread
+
+    // Return a new ShardedSet representing the union of *this and b
+    ShardedSet set_union(const ShardedSet& b) const;
+
+    // Return a new ShardedSet representing the intersection of *this and b
+    ShardedSet set_intersection(const ShardedSet& b) const;
+
+    // Return a new ShardedSet representing the difference between *this and b
+    ShardedSet set_difference(const ShardedSet& b) const;
+
+private:
+    struct Shard {
+        mutable std::shared_mutex mutex;  // exclusive for insert, shared for reading
+        Set S;
+    };
+
+    std::vector<std::unique_ptr<Shard>> shards;  // shards[i] holds smaller values than shards[i + 1]
+
+    std::uint32_t min_key;  // min_value, as a key (see key_of)
+    std::uint64_t width;    // number of values in each shard (the last shard may hold fewer)
+
+    // Constructor: create an empty set with the same shards as b
+    struct same_shards_as_t {};
+    ShardedSet(same_shards_as_t, const ShardedSet& b);
+
+    // Return x as an unsigned key, such that x < y if and only if key_of(x) < key_of(y)
+    static std::uint32_t key_of(int x);
+
+    // Return the index of the shard for value x
+    std::size_t shard_of(int x) const;
+
+    // Return true, if *this and b partition the values in the same way
+    bool same_shards(const ShardedSet& b) const;
+
+    // Lock all shards for reading, in increasing order of the shards
+    std::vector<std::shared_lock<std::shared_mutex>> lock_all() const;
+
+    // Return a new ShardedSet whose shard i is op(shards[i]->S, b.shards[i]->S)
+    template <typename Operation>
+    ShardedSet combine(const ShardedSet& b, Operation op) const;
+};
@@ -1,8 +1,14 @@
 #include <iostream>
 #include <sstream>
+#include <iterator>
+#include <stdexcept>
+#include <thread>
+#include <utility>  //std::move
 #include <cassert>
 
 #include "set.hpp"
+#include "set_stream.hpp"
+#include "sharded_set.hpp"
 
 int main() {
     /******************************************************
@@ -364,6 +370,231 @@ int main() {
         assert(S3.is_subset(Set{3}) and Set{3}.is_subset(S3));  // S3 == {3}
     }
 
+    assert(Set::get_count_nodes() == 0);
+
+    /******************************************************
+     * TEST PHASE 10                                      *
+     * Set::Builder and streaming set operations          *
+     ******************************************************/
+    std::cout << "\nTEST PHASE 10: Set::Builder and streaming set operations\n";
+
+    {
+        Set::Builder B{};
+        B.add(1);
+        B.add(4);
+        B.add(7);
+        assert(Set::get_count_nodes() == 4);  // Builder has a dummy node
+
+        Set S1 = B.finish();
+        assert(S1.cardinality() == 3);
+        assert(Set::get_count_nodes() == 5);
+
+        // test
+        std::vector<int> A1{7, 4, 1};
+        assert(S1.is_subset(Set{A1}) and Set{A1}.is_subset(S1));  // S1 == {1, 4, 7}
+
+        // sorted streams, with repeated values
+        std::istringstream in1{"1 3 3 5 8"};
+        std::istringstream in2{"2 3 8 8 9"};
+        std::istream_iterator<int> last{};
+
+        std::ostringstream os{};
+        set_stream::set_union(std::istream_iterator<int>{in1}, last, std::istream_iterator<int>{in2},
+                              last, [&os](int x) { os << x << " "; });
+        assert((os.str() == std::string{"1 2 3 5 8 9 "}));
+
+        std::vector<int> A2{1, 3, 3, 5, 8};
+        std::vector<int> A3{2, 3, 8, 8, 9};
+
+        Set S2 = set_stream::set_intersection(A2.begin(), A2.end(), A3.begin(), A3.end());
+        assert(S2.cardinality() == 2);
+        std::vector<int> A4{3, 8};
+        assert(S2.is_subset(Set{A4}) and Set{A4}.is_subset(S2));  // S2 == {3, 8}
+
+        Set S3 = set_stream::set_difference(A2.begin(), A2.end(), A3.begin(), A3.end());
+        assert(S3.cardinality() == 2);
+        std::vector<int> A5{1, 5};
+        assert(S3.is_subset(Set{A5}) and Set{A5}.is_subset(S3));  // S3 == {1, 5}
+
+        Set S4 = set_stream::set_union(A2.begin(), A2.end(), A3.begin(), A3.end());
+        assert(S4.cardinality() == 6);
+        assert(S4.is_subset(Set{A2}.set_union(Set{A3})) and Set{A2}.set_union(Set{A3}).is_subset(S4));
+
+        Set S5 = set_stream::set_difference(A2.begin(), A2.end(), A2.begin(), A2.end());
+        assert(S5.empty());
+
+        // inputs that are not sorted are rejected
+        std::vector<int> A6{1, 5, 4};
+        bool thrown = false;
+        try {
+            set_stream::set_union(A6.begin(), A6.end(), A2.begin(), A2.end());
+        } catch (const std::invalid_argument&) {
+            thrown = true;
+        }
+        assert(thrown);
+
+        thrown = false;
+        try {
+            Set::Builder B2{};
+            B2.add(2);
+            B2.add(2);
+        } catch (const std::invalid_argument&) {
+            thrown = true;
+        }
+        assert(thrown);
+    }
+
+    assert(Set::get_count_nodes() == 0);
+
+    /******************************************************
+     * TEST PHASE 11                                      *
+     * Parallel constructor from a vector                 *
+     ******************************************************/
+    std::cout << "\nTEST PHASE 11: parallel constructor from a vector\n";
+
+    {
+        std::vector<int> A1{4, 3, 4, 20, 15};  // note the non-unique values
+
+        Set S1{Set::par, A1};
+        assert(Set::get_count_nodes() == 5);
+
+        assert(S1.cardinality() == 4);
+        assert(S1.is_subset(Set{A1}) and Set{A1}.is_subset(S1));
+
+        Set S2{Set::par, std::vector<int>{}};
+        assert(S2.empty());
+
+        // large enough to be split among 4 threads
+        std::vector<int> A2(1 << 18);
+        for (std::size_t i = 0; i < A2.size(); ++i) {
+            A2[i] = static_cast<int>((i * 7919) % 100000) - 50000;
+        }
+
+        Set S3{Set::parallel_policy{4}, A2};
+        assert(S3.cardinality() == 100000);
+
+        // test: S3 == { -50000, ..., 49999 }
+        Set::Builder B{};
+        for (int x = -50000; x < 50000; ++x) {
+            B.add(x);
+        }
+
+        std::ostringstream os1{};
+        std::ostringstream os2{};
+        os1 << S3;
+        os2 << B.finish();
+        assert(os1.str() == os2.str());
+    }
+
+    assert(Set::get_count_nodes() == 0);
+
+    /******************************************************
+     * TEST PHASE 12                                      *
+     * insert and ShardedSet                              *
+     ******************************************************/
+    std::cout << "\nTEST PHASE 12: insert and ShardedSet\n";
+
+    {
+        Set S1{};
+        assert(S1.insert(5));
+        assert(S1.insert(1));
+        assert(S1.insert(3));
+        assert(!S1.insert(3));  // already an element
+        assert(Set::get_count_nodes() == 4);
+
+        std::ostringstream os{};
+        os << S1;
+        assert((os.str() == std::string{"{ 1 3 5 }"}));
+
+        // 8 threads insert the values 0, 1, ..., 799 (each value twice) into 4 shards
+        ShardedSet SS1{4, 0, 799};
+        assert(SS1.empty());
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 8; ++t) {
+            threads.emplace_back([&SS1, t]() {
+                for (int x = 0; x < 200; ++x) {
+                    SS1.insert((t % 4) * 200 + x);
+                    assert(SS1.member((t % 4) * 200 + x));
+                }
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+
+        assert(SS1.cardinality() == 800);
+        assert(SS1.member(0) and SS1.member(799) and !SS1.member(800) and !SS1.member(-1));
+
+        // values outside [0, 799] go to the first and last shards
+        ShardedSet SS2{4, 0, 799};
+        SS2.insert(-10);
+        SS2.insert(500);
+        SS2.insert(1000);
+
+        Set S2 = SS2.to_set();
+        std::vector<int> A1{-10, 500, 1000};
+        assert(S2.is_subset(Set{A1}) and Set{A1}.is_subset(S2));  // S2 == {-10, 500, 1000}
+
+        ShardedSet SS3 = SS1.set_union(SS2);
+        assert(SS3.cardinality() == 802);
+
+        ShardedSet SS4 = SS1.set_intersection(SS2);
+        assert(SS4.cardinality() == 1 and SS4.member(500));
+
+        ShardedSet SS5 = SS2.set_difference(SS1);
+        assert(SS5.cardinality() == 2 and !SS5.member(500));
+
+        assert(SS1.set_difference(SS1).empty());
+
+        // set operations require the same shards
+        bool thrown = false;
+        try {
+            SS1.set_union(ShardedSet{2, 0, 799});
+        } catch (const std::invalid_argument&) {
+            thrown = true;
+        }
+        assert(thrown);
+
+        // a moved-from ShardedSet is empty
+        ShardedSet SS7 = SS1.set_union(SS2);
+        ShardedSet SS8{std::move(SS7)};
+        assert(SS8.cardinality() == 802);
+        assert(SS7.empty() and !SS7.member(500) and SS7.to_set().empty());
+        assert(SS7.set_union(SS7).empty());
+
+        thrown = false;
+        try {
+            SS7.insert(500);
+        } catch (const std::logic_error&) {
+            thrown = true;
+        }
+        assert(thrown);
+
+        // a ShardedSet needs at least one shard and a non-empty range
+        thrown = false;
+        try {
+            ShardedSet SS6{0, 0, 799};
+        } catch (const std::invalid_argument&) {
+            thrown = true;
+        }
+        assert(thrown);
+
+        thrown = false;
+        try {
+            ShardedSet SS6{4, 799, 0};
+        } catch (const std::invalid_argument&) {
+            thrown = true;
+        }
+        assert(thrown);
+        assert(SS1.set_union(SS1).cardinality() == 800);
+
+        // to_set returns the elements in increasing order
+        Set S3 = SS3.to_set();
+        assert(S3.cardinality() == 802);
+        assert(SS1.to_set().is_subset(S3) and S2.is_subset(S3));
+    }
+
     assert(Set::get_count_nodes() == 0);
     std::cout << "\nSuccess!!\n";
 }